@@ -5,7 +5,10 @@
 #include <gui/elements.h>
 #include <furi_hal_speaker.h>
 #include <subghz/devices/devices.h>
+#include <cli/cli.h>
+#include <toolbox/args.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define TAG "RadioScannerApp"
 
@@ -13,12 +16,22 @@
 #define RADIO_SCANNER_DEFAULT_RSSI        (-100.0f)
 #define RADIO_SCANNER_DEFAULT_SENSITIVITY (-85.0f)
 #define RADIO_SCANNER_BUFFER_SZ           32
+#define RADIO_SCANNER_RSSI_Q_SHIFT        4
+#define RADIO_SCANNER_DEFAULT_WINDOW      4
+#define RADIO_SCANNER_DEFAULT_HYSTERESIS  4
+#define RADIO_SCANNER_DEFAULT_HANG_MS     250
 
 #define SUBGHZ_FREQUENCY_MIN  300000000
 #define SUBGHZ_FREQUENCY_MAX  928000000
 #define SUBGHZ_FREQUENCY_STEP 10000
 #define SUBGHZ_DEVICE_NAME    "cc1101_int"
 
+#define RADIO_SCANNER_CLI_COMMAND     "radio"
+#define RADIO_SCANNER_STREAM_SYNC     0xA5
+#define RADIO_SCANNER_STREAM_RECORDS  64
+#define RADIO_SCANNER_STREAM_POLL_MS  100
+#define RADIO_SCANNER_CLI_DETACH_MS   1000
+
 static const uint32_t freq_presets[] = {
     310000000, 315000000, 433920000, 868000000, 915000000
 };
@@ -35,6 +48,65 @@ static const char* step_preset_names[] = {
 };
 #define STEP_PRESET_COUNT 6
 
+// Rough supply current figures used for the low power estimate. Display,
+// backlight and other peripherals are not included.
+#define RADIO_SCANNER_CC1101_RX_UA    16000
+#define RADIO_SCANNER_CC1101_SLEEP_UA 1
+#define RADIO_SCANNER_MCU_RUN_UA      7000
+#define RADIO_SCANNER_MCU_STOP_UA     2
+
+#define RADIO_SCANNER_DEFAULT_LISTEN_MS 100
+#define RADIO_SCANNER_DEFAULT_SLEEP_MS  500
+#define RADIO_SCANNER_DEFAULT_BURST_MS  100
+
+static const uint32_t listen_presets[] = {
+    50, 100, 250, 500, 1000
+};
+static const char* listen_preset_names[] = {
+    "50 ms", "100 ms", "250 ms", "500 ms", "1 s"
+};
+#define LISTEN_PRESET_COUNT 5
+
+static const uint32_t sleep_presets[] = {
+    100, 250, 500, 1000, 2000, 5000
+};
+static const char* sleep_preset_names[] = {
+    "100 ms", "250 ms", "500 ms", "1 s", "2 s", "5 s"
+};
+#define SLEEP_PRESET_COUNT 6
+
+static const uint32_t burst_presets[] = {
+    10, 50, 100, 250, 500, 1000
+};
+#define BURST_PRESET_COUNT 6
+
+static const uint32_t window_presets[] = {
+    1, 2, 4, 8, 16
+};
+#define WINDOW_PRESET_COUNT 5
+
+static const uint32_t hysteresis_presets[] = {
+    0, 2, 4, 6, 10
+};
+#define HYSTERESIS_PRESET_COUNT 5
+
+static const uint32_t hang_presets[] = {
+    0, 100, 250, 500, 1000, 2000
+};
+static const char* hang_preset_names[] = {
+    "Off", "100 ms", "250 ms", "500 ms", "1 s", "2 s"
+};
+#define HANG_PRESET_COUNT 6
+
+static uint8_t radio_scanner_preset_index(const uint32_t* presets, uint8_t count, uint32_t value) {
+    for(uint8_t i = 0; i < count; i++) {
+        if(presets[i] == value) {
+            return i;
+        }
+    }
+    return 0;
+}
+
 static void radio_scanner_draw_callback(Canvas* canvas, void* context) {
     furi_assert(canvas);
     furi_assert(context);
@@ -85,13 +157,18 @@ static void radio_scanner_draw_callback(Canvas* canvas, void* context) {
 
     canvas_draw_frame(canvas, 65, 48, 63, 16);
     canvas_draw_line(canvas, 66, 49, 126, 49);
-    if(app->scanning) {
+    if(app->radio_asleep) {
+        canvas_draw_str(canvas, 68, 58, "SLEEP");
+    } else if(app->scanning) {
         canvas_draw_str(canvas, 68, 58, "SCAN");
         const char* dir = app->scan_direction == ScanDirectionUp ? "\x1E" : "\x1F";
         canvas_draw_str(canvas, 100, 58, dir);
     } else {
         canvas_draw_str(canvas, 68, 58, "LOCKED");
     }
+    if(app->low_power) {
+        canvas_draw_str(canvas, 112, 58, "LP");
+    }
 
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "Exit radio_scanner_draw_callback");
@@ -119,6 +196,29 @@ static void radio_scanner_rx_callback(const void* data, size_t size, void* conte
 #endif
 }
 
+// Called from the scan loop. Never blocks: when the host falls behind and the
+// buffer is full the record is dropped and counted instead.
+static void radio_scanner_stream_push(RadioScannerApp* app, RadioScannerStreamType type) {
+    if(!app->stream_attached) {
+        return;
+    }
+    if(type == RadioScannerStreamSample && !app->stream_samples) {
+        return;
+    }
+    RadioScannerStreamRecord record = {
+        .sync = RADIO_SCANNER_STREAM_SYNC,
+        .type = type,
+        .tick = furi_get_tick(),
+        .frequency = app->frequency,
+        .rssi_dbm_x10 = (int16_t)(app->rssi * 10.0f),
+    };
+    if(furi_stream_buffer_spaces_available(app->stream_buffer) < sizeof(record)) {
+        app->stream_dropped++;
+        return;
+    }
+    furi_stream_buffer_send(app->stream_buffer, &record, sizeof(record), 0);
+}
+
 static void radio_scanner_update_rssi(RadioScannerApp* app) {
     furi_assert(app);
 #ifdef FURI_DEBUG
@@ -129,6 +229,7 @@ static void radio_scanner_update_rssi(RadioScannerApp* app) {
 #ifdef FURI_DEBUG
         FURI_LOG_D(TAG, "Updated RSSI: %f", (double)app->rssi);
 #endif
+        radio_scanner_stream_push(app, RadioScannerStreamSample);
     } else {
         FURI_LOG_E(TAG, "Radio device is NULL");
         app->rssi = RADIO_SCANNER_DEFAULT_RSSI;
@@ -138,6 +239,105 @@ static void radio_scanner_update_rssi(RadioScannerApp* app) {
 #endif
 }
 
+static void radio_scanner_detector_reset(RadioScannerDetector* detector) {
+    detector->sum = 0;
+    detector->count = 0;
+    detector->head = 0;
+}
+
+static void radio_scanner_detector_add(RadioScannerDetector* detector, float rssi) {
+    int16_t sample = (int16_t)(rssi * (1 << RADIO_SCANNER_RSSI_Q_SHIFT));
+    if(detector->count == detector->window) {
+        detector->sum -= detector->samples[detector->head];
+    } else {
+        detector->count++;
+    }
+    detector->samples[detector->head] = sample;
+    detector->sum += sample;
+    detector->head = (detector->head + 1) % detector->window;
+}
+
+static int32_t radio_scanner_detector_average(const RadioScannerDetector* detector) {
+    return detector->count ? detector->sum / detector->count : 0;
+}
+
+static int32_t radio_scanner_detector_open_threshold(const RadioScannerApp* app) {
+    return (int32_t)(app->sensitivity * (1 << RADIO_SCANNER_RSSI_Q_SHIFT));
+}
+
+static int32_t radio_scanner_detector_close_threshold(const RadioScannerApp* app) {
+    return radio_scanner_detector_open_threshold(app) -
+           ((int32_t)app->hysteresis_db << RADIO_SCANNER_RSSI_Q_SHIFT);
+}
+
+static void radio_scanner_detector_hold(RadioScannerDetector* detector) {
+    detector->holding = true;
+    detector->signal_lost = false;
+    detector->hold_tick = furi_get_tick();
+    detector->hits++;
+}
+
+static uint32_t radio_scanner_ticks_to_ms(uint32_t ticks) {
+    return (uint32_t)((uint64_t)ticks * 1000 / furi_kernel_get_tick_frequency());
+}
+
+// Shifts the hold timers past a period in which no samples were taken, so
+// that time neither counts toward the hang time nor the recorded dwell.
+static void radio_scanner_detector_pause(RadioScannerDetector* detector, uint32_t ticks) {
+    detector->hold_tick += ticks;
+    detector->lost_tick += ticks;
+}
+
+// Drops a hold without recording dwell, used when the user takes over.
+static void radio_scanner_detector_cancel(RadioScannerDetector* detector) {
+    detector->holding = false;
+    detector->signal_lost = false;
+}
+
+// Runs while scanning is stopped. Resumes scanning once the averaged RSSI has
+// stayed below the close threshold for the hang time; a signal that returns
+// within the hang time counts as a flap that did not cost a retune.
+static void radio_scanner_process_hold(RadioScannerApp* app) {
+    RadioScannerDetector* detector = &app->detector;
+    radio_scanner_detector_add(detector, app->rssi);
+    if(!detector->holding) {
+        return;
+    }
+
+    uint32_t now = furi_get_tick();
+    if(radio_scanner_detector_average(detector) > radio_scanner_detector_close_threshold(app)) {
+        if(detector->signal_lost) {
+            detector->signal_lost = false;
+            detector->flaps++;
+        }
+        return;
+    }
+    if(!detector->signal_lost) {
+        detector->signal_lost = true;
+        detector->lost_tick = now;
+    }
+    if(radio_scanner_ticks_to_ms(now - detector->lost_tick) < app->hang_ms) {
+        return;
+    }
+
+    uint32_t dwell_ms = radio_scanner_ticks_to_ms(now - detector->hold_tick);
+    detector->holding = false;
+    detector->signal_lost = false;
+    detector->releases++;
+    detector->dwell_total_ms += dwell_ms;
+    if(dwell_ms > detector->dwell_max_ms) {
+        detector->dwell_max_ms = dwell_ms;
+    }
+    app->scanning = true;
+    FURI_LOG_I(
+        TAG,
+        "Released %lu after %lu ms (hits %lu, flaps %lu)",
+        app->frequency,
+        dwell_ms,
+        detector->hits,
+        detector->flaps);
+}
+
 static void radio_scanner_load_modulation(RadioScannerApp* app) {
     FuriHalSubGhzPreset preset;
     switch(app->modulation) {
@@ -173,11 +373,140 @@ static void radio_scanner_apply_frequency(RadioScannerApp* app) {
     }
 }
 
+// Only a locked channel is duty cycled. A sweep keeps the radio awake: sleeping
+// mid-sweep would skip channels at random, and a full pass at 10 kHz steps is
+// far longer than any sensible sleep period.
+static bool radio_scanner_power_duty_cycled(const RadioScannerApp* app) {
+    return app->low_power && !app->scanning;
+}
+
+// Average supply current over one listen/sleep period.
+static uint32_t radio_scanner_power_estimate_ua(const RadioScannerApp* app) {
+    uint32_t awake_ua = RADIO_SCANNER_CC1101_RX_UA + RADIO_SCANNER_MCU_RUN_UA;
+    if(!radio_scanner_power_duty_cycled(app)) {
+        return awake_ua;
+    }
+    uint32_t asleep_ua = RADIO_SCANNER_CC1101_SLEEP_UA + RADIO_SCANNER_MCU_STOP_UA;
+    uint32_t period_ms = app->listen_ms + app->sleep_ms;
+    return (awake_ua * app->listen_ms + asleep_ua * app->sleep_ms) / period_ms;
+}
+
+// Chance that a burst of burst_ms on the monitored channel overlaps a listen
+// window, assuming the burst start is uncorrelated with the duty cycle.
+static uint8_t radio_scanner_power_detection_pct(const RadioScannerApp* app) {
+    if(!radio_scanner_power_duty_cycled(app)) {
+        return 100;
+    }
+    uint32_t period_ms = app->listen_ms + app->sleep_ms;
+    uint32_t covered_ms = app->burst_ms + app->listen_ms;
+    if(covered_ms >= period_ms) {
+        return 100;
+    }
+    return (uint8_t)(covered_ms * 100 / period_ms);
+}
+
+static void radio_scanner_speaker_acquire(RadioScannerApp* app) {
+    if(furi_hal_speaker_acquire(30)) {
+        app->speaker_acquired = true;
+        subghz_devices_set_async_mirror_pin(app->radio_device, &gpio_speaker);
+    } else {
+        app->speaker_acquired = false;
+        FURI_LOG_E(TAG, "Failed to acquire speaker");
+    }
+}
+
+static void radio_scanner_speaker_release(RadioScannerApp* app) {
+    if(app->speaker_acquired && furi_hal_speaker_is_mine()) {
+        subghz_devices_set_async_mirror_pin(app->radio_device, NULL);
+        furi_hal_speaker_release();
+    }
+    app->speaker_acquired = false;
+}
+
+static void radio_scanner_power_sleep(RadioScannerApp* app) {
+    subghz_devices_flush_rx(app->radio_device);
+    subghz_devices_stop_async_rx(app->radio_device);
+    subghz_devices_idle(app->radio_device);
+    subghz_devices_sleep(app->radio_device);
+    // Holding the speaker keeps the power service in insomnia, which would
+    // stop the MCU from entering tickless stop mode while the radio sleeps.
+    app->speaker_paused = app->speaker_acquired;
+    radio_scanner_speaker_release(app);
+    app->radio_asleep = true;
+    app->rssi = RADIO_SCANNER_DEFAULT_RSSI;
+    app->power_tick = furi_get_tick();
+#ifdef FURI_DEBUG
+    FURI_LOG_D(TAG, "Radio asleep for %lu ms", app->sleep_ms);
+#endif
+}
+
+static void radio_scanner_power_wake(RadioScannerApp* app) {
+    // The CC1101 drops PATABLE and test registers in SLEEP, so reload the preset.
+    subghz_devices_idle(app->radio_device);
+    radio_scanner_load_modulation(app);
+    subghz_devices_set_frequency(app->radio_device, app->frequency);
+    subghz_devices_start_async_rx(app->radio_device, radio_scanner_rx_callback, app);
+    if(app->speaker_paused) {
+        app->speaker_paused = false;
+        radio_scanner_speaker_acquire(app);
+    }
+    radio_scanner_detector_reset(&app->detector);
+    app->radio_asleep = false;
+    app->power_tick = furi_get_tick();
+#ifdef FURI_DEBUG
+    FURI_LOG_D(TAG, "Radio awake");
+#endif
+}
+
+// Puts the radio to sleep once a listen window has passed without a carrier.
+static void radio_scanner_power_update(RadioScannerApp* app) {
+    if(!app->low_power || app->radio_asleep || !app->radio_device) {
+        return;
+    }
+    if(!radio_scanner_power_duty_cycled(app) || app->detector.holding || app->rssi > app->sensitivity) {
+        app->power_tick = furi_get_tick();
+        return;
+    }
+    if(furi_get_tick() - app->power_tick >= furi_ms_to_ticks(app->listen_ms)) {
+        radio_scanner_power_sleep(app);
+    }
+}
+
+// Ticks the main loop may block for input: the rest of the sleep period while
+// the radio is down, so the MCU can drop into tickless idle, otherwise the
+// regular 10 ms poll.
+static uint32_t radio_scanner_power_wait_ticks(const RadioScannerApp* app) {
+    if(!app->radio_asleep) {
+        return 10;
+    }
+    uint32_t sleep_ticks = furi_ms_to_ticks(app->sleep_ms);
+    uint32_t elapsed = furi_get_tick() - app->power_tick;
+    return elapsed < sleep_ticks ? sleep_ticks - elapsed : 0;
+}
+
 static uint32_t settings_view_exit_callback(void* context) {
     UNUSED(context);
     return VIEW_NONE;
 }
 
+static void radio_scanner_power_update_items(RadioScannerApp* app) {
+    char text[16];
+    if(app->burst_item) {
+        snprintf(
+            text,
+            sizeof(text),
+            "%lums %u%%",
+            app->burst_ms,
+            radio_scanner_power_detection_pct(app));
+        variable_item_set_current_value_text(app->burst_item, text);
+    }
+    if(app->power_draw_item) {
+        uint32_t ua = radio_scanner_power_estimate_ua(app);
+        snprintf(text, sizeof(text), "%lu.%lu mA", ua / 1000, (ua % 1000) / 100);
+        variable_item_set_current_value_text(app->power_draw_item, text);
+    }
+}
+
 static void frequency_change_callback(VariableItem* item) {
     RadioScannerApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -185,6 +514,8 @@ static void frequency_change_callback(VariableItem* item) {
 
     if(index < FREQ_PRESET_COUNT - 1) {
         app->frequency = freq_presets[index];
+        radio_scanner_detector_cancel(&app->detector);
+        radio_scanner_detector_reset(&app->detector);
         radio_scanner_apply_frequency(app);
     }
 }
@@ -197,6 +528,8 @@ static void modulation_change_callback(VariableItem* item) {
     const char* mod_names[] = {"OOK270", "OOK650", "2FSK238", "2FSK476"};
     variable_item_set_current_value_text(item, mod_names[index]);
 
+    radio_scanner_detector_cancel(&app->detector);
+    radio_scanner_detector_reset(&app->detector);
     if(app->radio_device) {
         subghz_devices_flush_rx(app->radio_device);
         subghz_devices_stop_async_rx(app->radio_device);
@@ -220,9 +553,11 @@ static void scanning_change_callback(VariableItem* item) {
     RadioScannerApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
     app->scanning = (index == 1);
+    radio_scanner_detector_cancel(&app->detector);
 
     const char* scan_names[] = {"Locked", "Scanning"};
     variable_item_set_current_value_text(item, scan_names[index]);
+    radio_scanner_power_update_items(app);
 }
 
 static void sensitivity_change_callback(VariableItem* item) {
@@ -242,6 +577,76 @@ static void step_size_change_callback(VariableItem* item) {
     variable_item_set_current_value_text(item, step_preset_names[index]);
 }
 
+static void low_power_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->low_power = (index == 1);
+    app->power_tick = furi_get_tick();
+
+    const char* power_names[] = {"Off", "On"};
+    variable_item_set_current_value_text(item, power_names[index]);
+    radio_scanner_power_update_items(app);
+}
+
+static void listen_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->listen_ms = listen_presets[index];
+    variable_item_set_current_value_text(item, listen_preset_names[index]);
+    radio_scanner_power_update_items(app);
+}
+
+static void sleep_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->sleep_ms = sleep_presets[index];
+    variable_item_set_current_value_text(item, sleep_preset_names[index]);
+    radio_scanner_power_update_items(app);
+}
+
+static void burst_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->burst_ms = burst_presets[index];
+    radio_scanner_power_update_items(app);
+}
+
+static void radio_scanner_detector_update_items(RadioScannerApp* app) {
+    if(app->detector_stats_item) {
+        char text[16];
+        snprintf(text, sizeof(text), "%lu / %lu", app->detector.hits, app->detector.flaps);
+        variable_item_set_current_value_text(app->detector_stats_item, text);
+    }
+}
+
+static void window_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->detector.window = window_presets[index];
+    radio_scanner_detector_reset(&app->detector);
+
+    char text[8];
+    snprintf(text, sizeof(text), "%lu", window_presets[index]);
+    variable_item_set_current_value_text(item, text);
+}
+
+static void hysteresis_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->hysteresis_db = hysteresis_presets[index];
+
+    char text[8];
+    snprintf(text, sizeof(text), "%u dB", app->hysteresis_db);
+    variable_item_set_current_value_text(item, text);
+}
+
+static void hang_change_callback(VariableItem* item) {
+    RadioScannerApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+    app->hang_ms = hang_presets[index];
+    variable_item_set_current_value_text(item, hang_preset_names[index]);
+}
+
 static void radio_scanner_setup_settings_menu(RadioScannerApp* app) {
     VariableItemList* list = app->variable_item_list;
     VariableItem* item;
@@ -294,6 +699,49 @@ static void radio_scanner_setup_settings_menu(RadioScannerApp* app) {
     }
     variable_item_set_current_value_index(item, step_index);
     variable_item_set_current_value_text(item, step_preset_names[step_index]);
+
+    char text[8];
+    item = variable_item_list_add(list, "RSSI Avg", WINDOW_PRESET_COUNT, window_change_callback, app);
+    variable_item_set_current_value_index(
+        item, radio_scanner_preset_index(window_presets, WINDOW_PRESET_COUNT, app->detector.window));
+    snprintf(text, sizeof(text), "%u", app->detector.window);
+    variable_item_set_current_value_text(item, text);
+
+    item = variable_item_list_add(list, "Hysteresis", HYSTERESIS_PRESET_COUNT, hysteresis_change_callback, app);
+    variable_item_set_current_value_index(
+        item, radio_scanner_preset_index(hysteresis_presets, HYSTERESIS_PRESET_COUNT, app->hysteresis_db));
+    snprintf(text, sizeof(text), "%u dB", app->hysteresis_db);
+    variable_item_set_current_value_text(item, text);
+
+    item = variable_item_list_add(list, "Hang Time", HANG_PRESET_COUNT, hang_change_callback, app);
+    uint8_t hang_index = radio_scanner_preset_index(hang_presets, HANG_PRESET_COUNT, app->hang_ms);
+    variable_item_set_current_value_index(item, hang_index);
+    variable_item_set_current_value_text(item, hang_preset_names[hang_index]);
+
+    app->detector_stats_item = variable_item_list_add(list, "Hits/Flaps", 1, NULL, app);
+    radio_scanner_detector_update_items(app);
+
+    item = variable_item_list_add(list, "Low Power", 2, low_power_change_callback, app);
+    const char* power_names[] = {"Off", "On"};
+    variable_item_set_current_value_index(item, app->low_power ? 1 : 0);
+    variable_item_set_current_value_text(item, power_names[app->low_power ? 1 : 0]);
+
+    item = variable_item_list_add(list, "Listen", LISTEN_PRESET_COUNT, listen_change_callback, app);
+    uint8_t listen_index = radio_scanner_preset_index(listen_presets, LISTEN_PRESET_COUNT, app->listen_ms);
+    variable_item_set_current_value_index(item, listen_index);
+    variable_item_set_current_value_text(item, listen_preset_names[listen_index]);
+
+    item = variable_item_list_add(list, "Sleep", SLEEP_PRESET_COUNT, sleep_change_callback, app);
+    uint8_t sleep_index = radio_scanner_preset_index(sleep_presets, SLEEP_PRESET_COUNT, app->sleep_ms);
+    variable_item_set_current_value_index(item, sleep_index);
+    variable_item_set_current_value_text(item, sleep_preset_names[sleep_index]);
+
+    app->burst_item = variable_item_list_add(list, "Det. Burst", BURST_PRESET_COUNT, burst_change_callback, app);
+    variable_item_set_current_value_index(
+        app->burst_item, radio_scanner_preset_index(burst_presets, BURST_PRESET_COUNT, app->burst_ms));
+
+    app->power_draw_item = variable_item_list_add(list, "Est. Draw", 1, NULL, app);
+    radio_scanner_power_update_items(app);
 }
 
 static bool radio_scanner_init_subghz(RadioScannerApp* app) {
@@ -339,16 +787,12 @@ static bool radio_scanner_init_subghz(RadioScannerApp* app) {
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "Asynchronous RX started");
 #endif
-    if(furi_hal_speaker_acquire(30)) {
-        app->speaker_acquired = true;
-        subghz_devices_set_async_mirror_pin(device, &gpio_speaker);
+    radio_scanner_speaker_acquire(app);
 #ifdef FURI_DEBUG
+    if(app->speaker_acquired) {
         FURI_LOG_D(TAG, "Speaker acquired and audio enabled by default");
-#endif
-    } else {
-        app->speaker_acquired = false;
-        FURI_LOG_E(TAG, "Failed to acquire speaker");
     }
+#endif
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "Exit radio_scanner_init_subghz");
 #endif
@@ -364,33 +808,26 @@ static void radio_scanner_process_scanning(RadioScannerApp* app) {
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "RSSI after update: %f", (double)app->rssi);
 #endif
-    bool signal_detected = (app->rssi > app->sensitivity);
+    // Each call looks at a freshly tuned channel, so only the new sample counts.
+    radio_scanner_detector_reset(&app->detector);
+    radio_scanner_detector_add(&app->detector, app->rssi);
+    bool signal_detected = radio_scanner_detector_average(&app->detector) >
+                           radio_scanner_detector_open_threshold(app);
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "Signal detected: %d", signal_detected);
 #endif
 
     if(signal_detected) {
-        if(app->scanning) {
-            app->scanning = false;
-#ifdef FURI_DEBUG
-            FURI_LOG_D(TAG, "Scanning stopped");
-#endif
-        }
-    } else {
-        if(!app->scanning) {
-            app->scanning = true;
-#ifdef FURI_DEBUG
-            FURI_LOG_D(TAG, "Scanning started");
-#endif
-        }
-    }
-
-    if(!app->scanning) {
+        radio_scanner_stream_push(app, RadioScannerStreamHit);
+        radio_scanner_detector_hold(&app->detector);
+        app->scanning = false;
 #ifdef FURI_DEBUG
+        FURI_LOG_D(TAG, "Scanning stopped");
         FURI_LOG_D(TAG, "Exit radio_scanner_process_scanning");
-        return;
 #endif
+        return;
     }
+
     uint32_t new_frequency = (app->scan_direction == ScanDirectionUp) ?
                                  app->frequency + SUBGHZ_FREQUENCY_STEP :
                                  app->frequency - SUBGHZ_FREQUENCY_STEP;
@@ -441,6 +878,160 @@ static void radio_scanner_process_scanning(RadioScannerApp* app) {
 #endif
 }
 
+static void radio_scanner_cli_write_record(Cli* cli, const RadioScannerStreamRecord* record, bool binary) {
+    if(binary) {
+        cli_write(cli, (const uint8_t*)record, sizeof(*record));
+        return;
+    }
+    char line[48];
+    int len = snprintf(
+        line,
+        sizeof(line),
+        "%c,%lu,%lu,%d\r\n",
+        record->type,
+        record->tick,
+        record->frequency,
+        record->rssi_dbm_x10);
+    cli_write(cli, (const uint8_t*)line, len);
+}
+
+static void radio_scanner_cli_stream(Cli* cli, RadioScannerApp* app, bool samples, bool binary) {
+    if(furi_mutex_acquire(app->stream_mutex, 0) != FuriStatusOk) {
+        printf("Stream already attached\r\n");
+        return;
+    }
+    if(!binary) {
+        printf("Streaming %s, press Ctrl+C to stop\r\n", samples ? "hits and samples" : "hits");
+    }
+
+    furi_stream_buffer_reset(app->stream_buffer);
+    app->stream_dropped = 0;
+    app->stream_samples = samples;
+    app->stream_attached = true;
+
+    uint32_t dropped_reported = 0;
+    RadioScannerStreamRecord record;
+    while(!app->stream_closing && cli_is_connected(cli) && !cli_cmd_interrupt_received(cli)) {
+        uint32_t dropped = app->stream_dropped;
+        if(dropped != dropped_reported) {
+            RadioScannerStreamRecord drop = {
+                .sync = RADIO_SCANNER_STREAM_SYNC,
+                .type = RadioScannerStreamDrop,
+                .tick = furi_get_tick(),
+                .frequency = dropped,
+                .rssi_dbm_x10 = 0,
+            };
+            radio_scanner_cli_write_record(cli, &drop, binary);
+            dropped_reported = dropped;
+            continue;
+        }
+        // The scan loop only ever sends whole records, so a read either
+        // times out empty or returns exactly one record.
+        if(furi_stream_buffer_receive(
+               app->stream_buffer, &record, sizeof(record), furi_ms_to_ticks(RADIO_SCANNER_STREAM_POLL_MS)) ==
+           sizeof(record)) {
+            radio_scanner_cli_write_record(cli, &record, binary);
+        }
+    }
+
+    app->stream_attached = false;
+    furi_mutex_release(app->stream_mutex);
+}
+
+static void radio_scanner_cli_stats(RadioScannerApp* app) {
+    const RadioScannerDetector* detector = &app->detector;
+    printf("Hits: %lu\r\n", detector->hits);
+    printf("Flaps: %lu\r\n", detector->flaps);
+    printf("Releases: %lu\r\n", detector->releases);
+    printf(
+        "Dwell: mean %lu ms, max %lu ms\r\n",
+        detector->releases ? detector->dwell_total_ms / detector->releases : 0,
+        detector->dwell_max_ms);
+    printf(
+        "Window: %u, hysteresis: %u dB, hang: %lu ms\r\n",
+        detector->window,
+        app->hysteresis_db,
+        app->hang_ms);
+}
+
+static void radio_scanner_cli_usage(void) {
+    printf("Usage:\r\n");
+    printf(RADIO_SCANNER_CLI_COMMAND " stats\r\n");
+    printf(RADIO_SCANNER_CLI_COMMAND " stream [hits|all] [text|bin]\r\n");
+    printf("\thits - hit events only (default)\r\n");
+    printf("\tall  - hit events and every RSSI sample\r\n");
+    printf("\ttext - <type>,<tick>,<freq Hz>,<rssi dBm x10> lines (default)\r\n");
+    printf("\tbin  - packed 12 byte records starting with 0xA5\r\n");
+}
+
+static void radio_scanner_cli_run(Cli* cli, FuriString* args, RadioScannerApp* app) {
+    FuriString* cmd = furi_string_alloc();
+    FuriString* arg = furi_string_alloc();
+    bool samples = false;
+    bool binary = false;
+    bool valid = args_read_string_and_trim(args, cmd);
+
+    if(valid && furi_string_equal(cmd, "stats")) {
+        radio_scanner_cli_stats(app);
+        furi_string_free(arg);
+        furi_string_free(cmd);
+        return;
+    }
+    valid = valid && furi_string_equal(cmd, "stream");
+
+    while(valid && args_read_string_and_trim(args, arg)) {
+        if(furi_string_equal(arg, "hits")) {
+            samples = false;
+        } else if(furi_string_equal(arg, "all")) {
+            samples = true;
+        } else if(furi_string_equal(arg, "text")) {
+            binary = false;
+        } else if(furi_string_equal(arg, "bin")) {
+            binary = true;
+        } else {
+            valid = false;
+        }
+    }
+
+    if(valid) {
+        radio_scanner_cli_stream(cli, app, samples, binary);
+    } else {
+        radio_scanner_cli_usage();
+    }
+
+    furi_string_free(arg);
+    furi_string_free(cmd);
+}
+
+// The in-flight count lets radio_scanner_app_free() wait for commands that are
+// already running. It does not close every race: the CLI drops its lock and
+// prints a newline (which can block on VCP TX) before calling this, so a
+// command dispatched just before cli_delete_command() may still enter after
+// teardown has seen a zero count. The firmware offers no hook to close that
+// window from the app.
+static void radio_scanner_cli_command(Cli* cli, FuriString* args, void* context) {
+    RadioScannerApp* app = context;
+    __atomic_fetch_add(&app->cli_in_flight, 1, __ATOMIC_SEQ_CST);
+    if(!app->stream_closing) {
+        radio_scanner_cli_run(cli, args, app);
+    }
+    __atomic_fetch_sub(&app->cli_in_flight, 1, __ATOMIC_SEQ_CST);
+}
+
+// Waits for running CLI commands to return. A stream stuck in cli_write()
+// behind a host that stopped reading cannot be interrupted, so give up after
+// RADIO_SCANNER_CLI_DETACH_MS instead of freezing the exit path.
+static bool radio_scanner_cli_wait_detached(RadioScannerApp* app) {
+    uint32_t start = furi_get_tick();
+    while(__atomic_load_n(&app->cli_in_flight, __ATOMIC_SEQ_CST) > 0) {
+        if(furi_get_tick() - start >= furi_ms_to_ticks(RADIO_SCANNER_CLI_DETACH_MS)) {
+            return false;
+        }
+        furi_delay_ms(10);
+    }
+    return true;
+}
+
 RadioScannerApp* radio_scanner_app_alloc() {
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "Enter radio_scanner_app_alloc");
@@ -469,11 +1060,33 @@ RadioScannerApp* radio_scanner_app_alloc() {
     app->frequency_step = SUBGHZ_FREQUENCY_STEP;
     app->rssi = RADIO_SCANNER_DEFAULT_RSSI;
     app->sensitivity = RADIO_SCANNER_DEFAULT_SENSITIVITY;
+    app->hysteresis_db = RADIO_SCANNER_DEFAULT_HYSTERESIS;
+    app->hang_ms = RADIO_SCANNER_DEFAULT_HANG_MS;
+    memset(&app->detector, 0, sizeof(app->detector));
+    app->detector.window = RADIO_SCANNER_DEFAULT_WINDOW;
     app->scanning = false;
     app->scan_direction = ScanDirectionUp;
     app->modulation = ModulationOok650;
     app->speaker_acquired = false;
+    app->speaker_paused = false;
     app->radio_device = NULL;
+    app->low_power = false;
+    app->radio_asleep = false;
+    app->listen_ms = RADIO_SCANNER_DEFAULT_LISTEN_MS;
+    app->sleep_ms = RADIO_SCANNER_DEFAULT_SLEEP_MS;
+    app->burst_ms = RADIO_SCANNER_DEFAULT_BURST_MS;
+    app->power_tick = 0;
+    app->burst_item = NULL;
+    app->power_draw_item = NULL;
+    app->detector_stats_item = NULL;
+    app->stream_attached = false;
+    app->stream_samples = false;
+    app->stream_closing = false;
+    app->stream_dropped = 0;
+    app->cli_in_flight = 0;
+    app->stream_buffer = furi_stream_buffer_alloc(
+        sizeof(RadioScannerStreamRecord) * RADIO_SCANNER_STREAM_RECORDS, sizeof(RadioScannerStreamRecord));
+    app->stream_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
     app->gui = furi_record_open(RECORD_GUI);
 
@@ -492,6 +1105,16 @@ RadioScannerApp* radio_scanner_app_alloc() {
 
     gui_add_view_port(app->gui, app->view_port, GuiLayerFullscreen);
 
+    app->cli = furi_record_open(RECORD_CLI);
+    // The stream loop only blocks on the record buffer, so it must not hold
+    // insomnia and keep low power mode out of tickless idle.
+    cli_add_command(
+        app->cli,
+        RADIO_SCANNER_CLI_COMMAND,
+        CliCommandFlagParallelSafe | CliCommandFlagInsomniaSafe,
+        radio_scanner_cli_command,
+        app);
+
     return app;
 }
 
@@ -500,21 +1123,27 @@ void radio_scanner_app_free(RadioScannerApp* app) {
 #ifdef FURI_DEBUG
     FURI_LOG_D(TAG, "Enter radio_scanner_app_free");
 #endif
-    if(app->speaker_acquired && furi_hal_speaker_is_mine()) {
-        subghz_devices_set_async_mirror_pin(app->radio_device, NULL);
-        furi_hal_speaker_release();
-        app->speaker_acquired = false;
+    // Detach any running CLI command before tearing down what it uses.
+    app->stream_closing = true;
+    cli_delete_command(app->cli, RADIO_SCANNER_CLI_COMMAND);
+    bool cli_detached = radio_scanner_cli_wait_detached(app);
+    furi_record_close(RECORD_CLI);
+
+    if(app->speaker_acquired) {
+        radio_scanner_speaker_release(app);
 #ifdef FURI_DEBUG
         FURI_LOG_D(TAG, "Speaker released");
 #endif
     }
 
     if(app->radio_device) {
-        subghz_devices_flush_rx(app->radio_device);
-        subghz_devices_stop_async_rx(app->radio_device);
+        if(!app->radio_asleep) {
+            subghz_devices_flush_rx(app->radio_device);
+            subghz_devices_stop_async_rx(app->radio_device);
 #ifdef FURI_DEBUG
-        FURI_LOG_D(TAG, "Asynchronous RX stopped");
+            FURI_LOG_D(TAG, "Asynchronous RX stopped");
 #endif
+        }
         subghz_devices_idle(app->radio_device);
         subghz_devices_sleep(app->radio_device);
         subghz_devices_end(app->radio_device);
@@ -540,6 +1169,17 @@ void radio_scanner_app_free(RadioScannerApp* app) {
 
     furi_record_close(RECORD_GUI);
 
+    if(!cli_detached) {
+        // The stream command is parked in a CLI write the host never drained.
+        // Leave what it touches on return allocated rather than free it under
+        // the command.
+        FURI_LOG_E(TAG, "CLI stream still attached, leaking its state");
+        return;
+    }
+
+    furi_stream_buffer_free(app->stream_buffer);
+    furi_mutex_free(app->stream_mutex);
+
     free(app);
 }
 
@@ -567,7 +1207,15 @@ int32_t radio_scanner_app(void* p) {
 #ifdef FURI_DEBUG
         FURI_LOG_D(TAG, "Main loop iteration");
 #endif
-        if(app->scanning) {
+        if(app->radio_asleep && radio_scanner_power_wait_ticks(app) == 0) {
+            radio_scanner_power_wake(app);
+        }
+
+        if(app->radio_asleep) {
+#ifdef FURI_DEBUG
+            FURI_LOG_D(TAG, "Radio is asleep");
+#endif
+        } else if(app->scanning) {
 #ifdef FURI_DEBUG
             FURI_LOG_D(TAG, "Scanning is active");
 #endif
@@ -577,23 +1225,31 @@ int32_t radio_scanner_app(void* p) {
             FURI_LOG_D(TAG, "Scanning is inactive, updating RSSI");
 #endif
             radio_scanner_update_rssi(app);
+            radio_scanner_process_hold(app);
         }
 
 #ifdef FURI_DEBUG
         FURI_LOG_D(TAG, "Checking for input events");
 #endif
-        if(furi_message_queue_get(app->event_queue, &event, 10) == FuriStatusOk) {
+        if(furi_message_queue_get(app->event_queue, &event, radio_scanner_power_wait_ticks(app)) ==
+           FuriStatusOk) {
 #ifdef FURI_DEBUG
             FURI_LOG_D(TAG, "Input event received: type=%d, key=%d", event.type, event.key);
 #endif
+            if(app->radio_asleep) {
+                radio_scanner_power_wake(app);
+            }
             if(event.type == InputTypeShort) {
                 if(event.key == InputKeyOk) {
+                    uint32_t settings_tick = furi_get_tick();
                     gui_remove_view_port(app->gui, app->view_port);
                     view_dispatcher_attach_to_gui(app->view_dispatcher, app->gui, ViewDispatcherTypeFullscreen);
                     radio_scanner_setup_settings_menu(app);
                     view_dispatcher_switch_to_view(app->view_dispatcher, RadioScannerViewSettings);
                     view_dispatcher_run(app->view_dispatcher);
                     gui_add_view_port(app->gui, app->view_port, GuiLayerFullscreen);
+                    app->power_tick = furi_get_tick();
+                    radio_scanner_detector_pause(&app->detector, app->power_tick - settings_tick);
                     FURI_LOG_I(TAG, "Returned from settings menu");
                 } else if(event.key == InputKeyUp) {
                     app->sensitivity += 1.0f;
@@ -603,6 +1259,7 @@ int32_t radio_scanner_app(void* p) {
                     FURI_LOG_I(TAG, "Decreased sensitivity: %f", (double)app->sensitivity);
                 } else if(event.key == InputKeyLeft) {
                     app->scanning = false;
+                    radio_scanner_detector_cancel(&app->detector);
                     uint32_t new_frequency = app->frequency - app->frequency_step;
                     if(subghz_devices_is_frequency_valid(app->radio_device, new_frequency)) {
                         subghz_devices_flush_rx(app->radio_device);
@@ -615,6 +1272,7 @@ int32_t radio_scanner_app(void* p) {
                     }
                 } else if(event.key == InputKeyRight) {
                     app->scanning = false;
+                    radio_scanner_detector_cancel(&app->detector);
                     uint32_t new_frequency = app->frequency + app->frequency_step;
                     if(subghz_devices_is_frequency_valid(app->radio_device, new_frequency)) {
                         subghz_devices_flush_rx(app->radio_device);
@@ -633,17 +1291,22 @@ int32_t radio_scanner_app(void* p) {
                 if(event.key == InputKeyLeft) {
                     app->scan_direction = ScanDirectionDown;
                     app->scanning = true;
+                    radio_scanner_detector_cancel(&app->detector);
                     FURI_LOG_I(TAG, "Resume scanning down");
                 } else if(event.key == InputKeyRight) {
                     app->scan_direction = ScanDirectionUp;
                     app->scanning = true;
+                    radio_scanner_detector_cancel(&app->detector);
                     FURI_LOG_I(TAG, "Resume scanning up");
                 }
             }
         }
 
+        radio_scanner_power_update(app);
         view_port_update(app->view_port);
-        furi_delay_ms(10);
+        if(!app->radio_asleep) {
+            furi_delay_ms(10);
+        }
     }
 
     radio_scanner_app_free(app);
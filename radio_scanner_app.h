@@ -6,6 +6,7 @@
 #include <gui/modules/variable_item_list.h>
 #include <gui/modules/text_input.h>
 #include <subghz/devices/devices.h>
+#include <cli/cli.h>
 
 typedef enum {
     RadioScannerViewScanner,
@@ -26,6 +27,43 @@ typedef enum {
     ModulationCount
 } ModulationType;
 
+#define RADIO_SCANNER_RSSI_WINDOW_MAX 16
+
+// Fixed-point signal detector. RSSI samples are kept in 1/16 dBm steps and
+// averaged over the last `window` samples taken on the current channel.
+typedef struct {
+    int16_t samples[RADIO_SCANNER_RSSI_WINDOW_MAX];
+    int32_t sum;
+    uint8_t count;
+    uint8_t head;
+    uint8_t window;
+    bool holding;
+    bool signal_lost;
+    uint32_t hold_tick;
+    uint32_t lost_tick;
+    uint32_t hits;
+    uint32_t flaps;
+    uint32_t releases;
+    uint32_t dwell_total_ms;
+    uint32_t dwell_max_ms;
+} RadioScannerDetector;
+
+typedef enum {
+    RadioScannerStreamHit = 'H',
+    RadioScannerStreamSample = 'S',
+    RadioScannerStreamDrop = 'D',
+} RadioScannerStreamType;
+
+// Record streamed to the CLI, sent as-is (little endian) in binary mode.
+// For drop records frequency holds the total number of dropped records.
+typedef struct __attribute__((packed)) {
+    uint8_t sync;
+    uint8_t type;
+    uint32_t tick;
+    uint32_t frequency;
+    int16_t rssi_dbm_x10;
+} RadioScannerStreamRecord;
+
 typedef struct {
     Gui* gui;
     ViewPort* view_port;
@@ -38,11 +76,32 @@ typedef struct {
     uint32_t frequency_step;
     float rssi;
     float sensitivity;
+    uint8_t hysteresis_db;
+    uint32_t hang_ms;
+    RadioScannerDetector detector;
     bool scanning;
     ScanDirection scan_direction;
     ModulationType modulation;
     const SubGhzDevice* radio_device;
     bool speaker_acquired;
+    bool speaker_paused;
+    bool low_power;
+    bool radio_asleep;
+    uint32_t listen_ms;
+    uint32_t sleep_ms;
+    uint32_t burst_ms;
+    uint32_t power_tick;
+    VariableItem* burst_item;
+    VariableItem* power_draw_item;
+    VariableItem* detector_stats_item;
+    Cli* cli;
+    FuriStreamBuffer* stream_buffer;
+    FuriMutex* stream_mutex;
+    volatile bool stream_attached;
+    volatile bool stream_samples;
+    volatile bool stream_closing;
+    volatile uint32_t stream_dropped;
+    uint32_t cli_in_flight;
     char text_buffer[32];
 } RadioScannerApp;
 
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Host side reader for the `radio stream` CLI command.
+
+Attaches to one or more Flipper serial ports (or any tty, e.g. a pseudo
+terminal standing in for a unit), starts streaming and prints every record
+tagged with the port it came from. Press Ctrl+C to stop; a per port summary
+is printed on exit.
+
+    tools/radio_stream.py /dev/ttyACM0 /dev/ttyACM1 --samples --binary
+"""
+
+import argparse
+import os
+import re
+import select
+import struct
+import sys
+import termios
+import tty
+
+SYNC = 0xA5
+RECORD = struct.Struct("<BBIIh")
+TYPES = b"HSD"
+LINE_RE = re.compile(rb"^([HSD]),(\d+),(\d+),(-?\d+)\r?$")
+
+
+class Unit:
+    def __init__(self, path, binary):
+        self.path = path
+        self.binary = binary
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            tty.setraw(self.fd)
+        self.buffer = b""
+        self.hits = 0
+        self.samples = 0
+        self.dropped = 0
+
+    def start(self, samples):
+        mode = "all" if samples else "hits"
+        fmt = "bin" if self.binary else "text"
+        os.write(self.fd, f"\rradio stream {mode} {fmt}\r".encode())
+
+    def read(self):
+        """Returns new bytes, or None once the unit has gone away."""
+        try:
+            return os.read(self.fd, 4096) or None
+        except OSError:
+            return None
+
+    def stop(self):
+        try:
+            os.write(self.fd, b"\x03")
+            if os.isatty(self.fd):
+                termios.tcdrain(self.fd)
+        except OSError:
+            pass
+        finally:
+            os.close(self.fd)
+
+    def feed(self, data):
+        self.buffer += data
+        return self._parse_binary() if self.binary else self._parse_text()
+
+    def _parse_text(self):
+        records = []
+        *lines, self.buffer = self.buffer.split(b"\n")
+        for line in lines:
+            m = LINE_RE.match(line)
+            if m:
+                kind, tick, freq, rssi = m.groups()
+                records.append((chr(kind[0]), int(tick), int(freq), int(rssi)))
+        return records
+
+    def _parse_binary(self):
+        records = []
+        while len(self.buffer) >= RECORD.size:
+            if self.buffer[0] != SYNC or self.buffer[1] not in TYPES:
+                self.buffer = self.buffer[1:]
+                continue
+            _, kind, tick, freq, rssi = RECORD.unpack_from(self.buffer)
+            self.buffer = self.buffer[RECORD.size:]
+            records.append((chr(kind), tick, freq, rssi))
+        return records
+
+    def account(self, record):
+        kind, _, freq, _ = record
+        if kind == "H":
+            self.hits += 1
+        elif kind == "S":
+            self.samples += 1
+        else:
+            self.dropped = freq
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("ports", nargs="+", help="serial ports or ttys to read")
+    parser.add_argument("--samples", action="store_true", help="also stream raw RSSI samples")
+    parser.add_argument("--binary", action="store_true", help="use the binary record format")
+    args = parser.parse_args()
+
+    attached = [Unit(path, args.binary) for path in args.ports]
+    for unit in attached:
+        unit.start(args.samples)
+    units = {unit.fd: unit for unit in attached}
+
+    try:
+        while units:
+            ready, _, _ = select.select(list(units), [], [])
+            for fd in ready:
+                unit = units[fd]
+                data = unit.read()
+                if data is None:
+                    print(f"{unit.path}: disconnected", file=sys.stderr)
+                    del units[fd]
+                    unit.stop()
+                    continue
+                for record in unit.feed(data):
+                    unit.account(record)
+                    kind, tick, freq, rssi = record
+                    if kind == "D":
+                        print(f"{unit.path} D tick={tick} dropped={freq}")
+                    else:
+                        print(f"{unit.path} {kind} tick={tick} freq={freq} rssi={rssi / 10:.1f}")
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        for unit in units.values():
+            unit.stop()
+        for unit in attached:
+            print(
+                f"{unit.path}: {unit.hits} hits, {unit.samples} samples, {unit.dropped} dropped",
+                file=sys.stderr,
+            )
+
+
+if __name__ == "__main__":
+    main()
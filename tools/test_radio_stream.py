@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Tests for radio_stream.py using pseudo terminals in place of Flipper units.
+
+    python3 tools/test_radio_stream.py
+"""
+
+import os
+import pty
+import select
+import signal
+import subprocess
+import sys
+import time
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import radio_stream  # noqa: E402
+
+SCRIPT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "radio_stream.py")
+
+
+def record(kind, tick, freq, rssi):
+    return radio_stream.RECORD.pack(radio_stream.SYNC, ord(kind), tick, freq, rssi)
+
+
+def read_until(fd, needle, timeout=2.0):
+    data = b""
+    deadline = time.monotonic() + timeout
+    while needle not in data and time.monotonic() < deadline:
+        ready, _, _ = select.select([fd], [], [], 0.05)
+        if ready:
+            data += os.read(fd, 4096)
+    return data
+
+
+class UnitParseTest(unittest.TestCase):
+    def open_unit(self, binary):
+        master, slave = pty.openpty()
+        unit = radio_stream.Unit(os.ttyname(slave), binary)
+        os.close(slave)
+        self.addCleanup(os.close, master)
+        self.addCleanup(unit.stop)
+        return master, unit
+
+    def test_start_sends_command(self):
+        master, unit = self.open_unit(binary=True)
+        unit.start(samples=True)
+        self.assertIn(b"radio stream all bin\r", read_until(master, b"bin\r"))
+
+    def test_text_records(self):
+        _, unit = self.open_unit(binary=False)
+        records = unit.feed(b">: radio stream hits text\r\nStreaming hits\r\nH,100,4339")
+        self.assertEqual(records, [])
+        records = unit.feed(b"20000,-655\r\nD,120,3,0\r\n")
+        self.assertEqual(records, [("H", 100, 433920000, -655), ("D", 120, 3, 0)])
+
+    def test_binary_split_record(self):
+        _, unit = self.open_unit(binary=True)
+        data = record("H", 7, 868000000, -801)
+        self.assertEqual(unit.feed(data[:5]), [])
+        self.assertEqual(unit.feed(data[5:]), [("H", 7, 868000000, -801)])
+
+    def test_binary_resync_after_junk(self):
+        _, unit = self.open_unit(binary=True)
+        data = b"banner\xa5\x00" + record("S", 1, 315000000, -1000) + record("D", 2, 9, 0)
+        self.assertEqual(unit.feed(data), [("S", 1, 315000000, -1000), ("D", 2, 9, 0)])
+
+    def test_account(self):
+        _, unit = self.open_unit(binary=True)
+        for r in unit.feed(record("H", 1, 1, 0) + record("S", 2, 1, 0) + record("D", 3, 4, 0)):
+            unit.account(r)
+        self.assertEqual((unit.hits, unit.samples, unit.dropped), (1, 1, 4))
+
+    def test_read_after_disconnect(self):
+        master, slave = pty.openpty()
+        unit = radio_stream.Unit(os.ttyname(slave), True)
+        os.close(slave)
+        os.close(master)
+        self.assertIsNone(unit.read())
+        unit.stop()
+
+
+class SessionTest(unittest.TestCase):
+    def test_unit_disconnect_keeps_others(self):
+        m1, s1 = pty.openpty()
+        m2, s2 = pty.openpty()
+        proc = subprocess.Popen(
+            [sys.executable, SCRIPT, "--binary", os.ttyname(s1), os.ttyname(s2)],
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+        )
+        try:
+            read_until(m1, b"bin\r")
+            read_until(m2, b"bin\r")
+            os.write(m1, record("H", 1, 433920000, -650))
+            time.sleep(0.2)
+            # Hang up unit 1: with every slave fd gone the reader sees EIO.
+            os.close(s1)
+            os.close(m1)
+            time.sleep(0.2)
+            os.write(m2, record("H", 2, 915000000, -700))
+            time.sleep(0.3)
+            self.assertIsNone(proc.poll())
+        finally:
+            proc.send_signal(signal.SIGINT)
+            out, err = proc.communicate(timeout=5)
+            os.close(s2)
+            os.close(m2)
+
+        out = out.decode()
+        self.assertNotIn("Traceback", err.decode())
+        self.assertIn("H tick=1 freq=433920000 rssi=-65.0", out)
+        self.assertIn("H tick=2 freq=915000000 rssi=-70.0", out)
+        self.assertIn("disconnected", err.decode())
+
+
+if __name__ == "__main__":
+    unittest.main()